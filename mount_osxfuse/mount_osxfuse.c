@@ -43,6 +43,7 @@
 #include <fuse_version.h>
 
 #include "mntopts.h"
+#include "mount_osxfuse_probes.h"
 
 static bool quiet_mode = false;
 static int signal_fd  = -1;
@@ -560,10 +561,13 @@ load_kext(void)
     long major;
     char *load_prog_path;
 
+    MOUNT_OSXFUSE_KEXT_LOAD_START();
+
     major = fuse_os_version_major_np();
 
     if (major < OSXFUSE_MIN_DARWIN_VERSION) {
         /* This is not a supported version of macOS */
+        MOUNT_OSXFUSE_KEXT_LOAD_DONE(EINVAL);
         return EINVAL;
     }
 
@@ -605,6 +609,8 @@ load_kext(void)
 Return:
     __Check_noErr_String(result, strerror(errno));
 
+    MOUNT_OSXFUSE_KEXT_LOAD_DONE(result);
+
     return result;
 }
 
@@ -655,6 +661,8 @@ send_fd(int sock_fd, int fd)
     char cmsgbuf[CMSG_SPACE(sizeof(fd))];
     struct cmsghdr *cmsgp;
 
+    MOUNT_OSXFUSE_SEND_FD_START(sock_fd, fd);
+
     vec.iov_base = &sendchar;
     vec.iov_len = sizeof(sendchar);
 
@@ -680,9 +688,12 @@ send_fd(int sock_fd, int fd)
     while ((retval = sendmsg(sock_fd, &msg, 0)) == -1 && errno == EINTR);
     if (retval != 1) {
         perror("sending file descriptor");
+        MOUNT_OSXFUSE_SEND_FD_DONE(sock_fd, -1);
         return -1;
     }
 
+    MOUNT_OSXFUSE_SEND_FD_DONE(sock_fd, 0);
+
     return 0;
 }
 
@@ -812,6 +823,8 @@ main(int argc, char **argv)
         errx(EX_USAGE, "missing mount point");
     }
 
+    MOUNT_OSXFUSE_OPTIONS_PARSED(altflags, mntflags);
+
     {
         char *commfd;
 
@@ -921,6 +934,8 @@ main(int argc, char **argv)
             break;
     }
 
+    MOUNT_OSXFUSE_KEXT_CHECKED();
+
     fdnam = getenv("FUSE_DEV_FD");
     if (fdnam) {
         errno = 0;
@@ -986,6 +1001,8 @@ mount:
         }
     }
 
+    MOUNT_OSXFUSE_DEVICE_OPENED(dindex, fd);
+
     while (true) {
         struct stat sbuf;
 
@@ -1165,7 +1182,9 @@ mount:
     }
 
     /* Finally! */
+    MOUNT_OSXFUSE_MOUNT_START(mntpath, dindex);
     result = mount(OSXFUSE_NAME, mntpath, mntflags, (void *)&args);
+    MOUNT_OSXFUSE_MOUNT_DONE(mntpath, dindex, result, result < 0 ? errno : 0);
 
     if (result < 0) {
         err(EX_OSERR, "failed to mount %s@/dev/" OSXFUSE_DEVICE_BASENAME "%d",
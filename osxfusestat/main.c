@@ -0,0 +1,568 @@
+/*
+ * Copyright (c) 2026 osxfuse contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of osxfuse nor the names of its contributors may be used
+ *    to endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * osxfusestat samples the counters and tunables of the file system
+ * periodically and prints per-interval deltas and rates.
+ *
+ * On macOS the nodes below vfs.generic.osxfuse are discovered once and then
+ * read by MIB. Writable nodes are tunables, nodes below a "counters" node are
+ * counters and everything else is a gauge. On Linux the files below
+ * /sys/fs/fuse/connections are opened once and then re-read with pread(2);
+ * they are all gauges or tunables. The Linux build does not need the osxfuse
+ * headers:
+ *
+ *   cc -std=gnu99 -o osxfusestat osxfusestat/main.c
+ */
+
+#include <err.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sysexits.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __APPLE__
+    #include <sys/sysctl.h>
+
+    #include <fuse_param.h>
+    #include <fuse_version.h>
+#else
+    #include <dirent.h>
+#endif
+
+#ifdef __APPLE__
+    #define STAT_SOURCE "vfs.generic." OSXFUSE_NAME
+#else
+    #define STAT_SOURCE "/sys/fs/fuse/connections"
+#endif
+
+#define STAT_NAME_MAX     128
+#define STAT_NODES_MAX    512
+#define STAT_INTERVAL_MAX 86400.0
+
+/*
+ * Only counters increase monotonically, so only counters get a rate. Gauges
+ * and tunables are printed with their change since the previous sample.
+ */
+enum stat_kind {
+    NODE_COUNTER,
+    NODE_GAUGE,
+    NODE_TUNABLE
+};
+
+static const char * const stat_kind_names[] = {
+    "counter", // NODE_COUNTER
+    "gauge",   // NODE_GAUGE
+    "tunable"  // NODE_TUNABLE
+};
+
+struct stat_node {
+    char           name[STAT_NAME_MAX];
+    enum stat_kind kind;
+#ifdef __APPLE__
+    int      mib[CTL_MAXNAME];
+    u_int    miblen;
+    bool     is_unsigned;
+#else
+    int      fd;
+#endif
+    int64_t  value;
+    int64_t  previous;
+};
+
+static struct stat_node nodes[STAT_NODES_MAX];
+static int              node_count = 0;
+
+static void showhelp(void);
+
+#ifdef __APPLE__
+
+/* Undocumented sysctl(3) interface used by sysctl(8) to walk the tree */
+#define SYSCTL_OID_NAME 1
+#define SYSCTL_OID_NEXT 2
+#define SYSCTL_OID_FMT  4
+
+static int
+node_add(const int *mib, u_int miblen)
+{
+    struct stat_node *node;
+    int     query[CTL_MAXNAME + 2];
+    char    fmt[sizeof(u_int) + 32];
+    size_t  fmtlen;
+    size_t  len;
+    u_int   kind;
+
+    query[0] = 0;
+    memcpy(query + 2, mib, miblen * sizeof(int));
+
+    query[1] = SYSCTL_OID_FMT;
+    fmtlen = sizeof(fmt);
+    if (sysctl(query, miblen + 2, fmt, &fmtlen, NULL, 0)) {
+        /* Skip nodes whose format does not fit instead of giving up */
+        return errno == ENOMEM ? 0 : errno;
+    }
+    memcpy(&kind, fmt, sizeof(kind));
+
+    if ((kind & CTLTYPE) != CTLTYPE_INT && (kind & CTLTYPE) != CTLTYPE_QUAD) {
+        /* Only numeric nodes can be sampled */
+        return 0;
+    }
+
+    if (node_count == STAT_NODES_MAX) {
+        return ENOSPC;
+    }
+    node = &nodes[node_count];
+
+    query[1] = SYSCTL_OID_NAME;
+    len = sizeof(node->name);
+    if (sysctl(query, miblen + 2, node->name, &len, NULL, 0)) {
+        /* Skip nodes whose name does not fit instead of giving up */
+        return errno == ENOMEM ? 0 : errno;
+    }
+
+    memcpy(node->mib, mib, miblen * sizeof(int));
+    node->miblen = miblen;
+    if (kind & CTLFLAG_WR) {
+        node->kind = NODE_TUNABLE;
+    } else if (strstr(node->name, ".counters.")) {
+        node->kind = NODE_COUNTER;
+    } else {
+        node->kind = NODE_GAUGE;
+    }
+    node->is_unsigned = fmtlen > sizeof(u_int) + 1 &&
+                        fmt[sizeof(u_int) + 1] == 'U';
+
+    node_count++;
+    return 0;
+}
+
+static int
+nodes_discover(void)
+{
+    int    root[CTL_MAXNAME];
+    size_t rootlen = CTL_MAXNAME;
+    int    control[CTL_MAXNAME];
+    size_t controllen = CTL_MAXNAME;
+    int    query[CTL_MAXNAME + 2];
+    int    next[CTL_MAXNAME];
+    size_t nextlen;
+    u_int  oidlen;
+    int    ret;
+
+    if (sysctlnametomib(STAT_SOURCE, root, &rootlen)) {
+        return errno;
+    }
+
+    /* The control nodes trigger actions, they are not tunables */
+    if (sysctlnametomib(STAT_SOURCE ".control", control, &controllen)) {
+        controllen = 0;
+    }
+
+    query[0] = 0;
+    query[1] = SYSCTL_OID_NEXT;
+    memcpy(query + 2, root, rootlen * sizeof(int));
+    oidlen = (u_int)rootlen;
+
+    while (true) {
+        nextlen = sizeof(next);
+        if (sysctl(query, oidlen + 2, next, &nextlen, NULL, 0)) {
+            if (errno == ENOENT) {
+                break;
+            }
+            return errno;
+        }
+        nextlen /= sizeof(int);
+
+        if (nextlen < rootlen ||
+            memcmp(next, root, rootlen * sizeof(int)) != 0) {
+            /* Left the subtree */
+            break;
+        }
+
+        if (controllen == 0 || nextlen < controllen ||
+            memcmp(next, control, controllen * sizeof(int)) != 0) {
+            ret = node_add(next, (u_int)nextlen);
+            if (ret) {
+                return ret;
+            }
+        }
+
+        memcpy(query + 2, next, nextlen * sizeof(int));
+        oidlen = (u_int)nextlen;
+    }
+
+    return 0;
+}
+
+static int
+node_read(struct stat_node *node)
+{
+    union {
+        int32_t i;
+        int64_t q;
+    } u;
+    size_t len = sizeof(u);
+
+    if (sysctl(node->mib, node->miblen, &u, &len, NULL, 0)) {
+        return errno;
+    }
+
+    if (len == sizeof(int32_t)) {
+        node->value = node->is_unsigned ? (int64_t)(uint32_t)u.i : u.i;
+    } else {
+        node->value = u.q;
+    }
+    return 0;
+}
+
+static void
+print_version(void)
+{
+    char   version[64] = { 0 };
+    size_t version_len = sizeof(version) - 1;
+
+    if (sysctlbyname(OSXFUSE_SYSCTL_VERSION_NUMBER, version, &version_len,
+                     NULL, 0) == 0) {
+        printf("# " OSXFUSE_DISPLAY_NAME " kernel extension %s\n", version);
+    }
+}
+
+#else /* !__APPLE__ */
+
+/* fusectl exposes no counters, only the number of waiting requests */
+static const struct {
+    const char     *file;
+    enum stat_kind  kind;
+} connection_files[] = {
+    { "waiting",              NODE_GAUGE   },
+    { "max_background",       NODE_TUNABLE },
+    { "congestion_threshold", NODE_TUNABLE },
+};
+
+static int
+nodes_discover(void)
+{
+    DIR           *dir;
+    struct dirent *entry;
+    char           path[PATH_MAX];
+    size_t         i;
+    int            open_error = 0;
+
+    dir = opendir(STAT_SOURCE);
+    if (!dir) {
+        return errno;
+    }
+
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+
+        for (i = 0; i < sizeof(connection_files) / sizeof(connection_files[0]);
+             i++) {
+            struct stat_node *node;
+            int fd;
+
+            snprintf(path, sizeof(path), STAT_SOURCE "/%s/%s", entry->d_name,
+                     connection_files[i].file);
+            fd = open(path, O_RDONLY);
+            if (fd < 0) {
+                /* The files are only readable by root */
+                if (!open_error) {
+                    open_error = errno;
+                }
+                continue;
+            }
+
+            if (node_count == STAT_NODES_MAX) {
+                close(fd);
+                closedir(dir);
+                return ENOSPC;
+            }
+            node = &nodes[node_count++];
+
+            snprintf(node->name, sizeof(node->name), "%.64s.%s", entry->d_name,
+                     connection_files[i].file);
+            node->kind = connection_files[i].kind;
+            node->fd = fd;
+        }
+    }
+
+    closedir(dir);
+    return node_count == 0 ? open_error : 0;
+}
+
+static int
+node_read(struct stat_node *node)
+{
+    char    buf[32];
+    ssize_t len;
+
+    len = pread(node->fd, buf, sizeof(buf) - 1, 0);
+    if (len < 0) {
+        return errno;
+    }
+    buf[len] = '\0';
+
+    errno = 0;
+    node->value = strtoll(buf, NULL, 10);
+    return errno;
+}
+
+static void
+print_version(void)
+{
+}
+
+#endif /* __APPLE__ */
+
+/* Wall-clock time, only used to timestamp exported samples */
+static double
+time_now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + (double)tv.tv_usec / 1e6;
+}
+
+/* Monotonic time for deadlines and intervals, immune to clock changes */
+static double
+time_monotonic(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void
+sleep_until(double deadline)
+{
+    double          remaining = deadline - time_monotonic();
+    struct timespec ts;
+
+    if (remaining <= 0) {
+        return;
+    }
+
+    ts.tv_sec = (time_t)remaining;
+    ts.tv_nsec = (long)((remaining - (double)ts.tv_sec) * 1e9);
+    while (nanosleep(&ts, &ts) == -1 && errno == EINTR);
+}
+
+static void
+print_sample(double timestamp, double elapsed, bool first, bool all, bool csv)
+{
+    bool header = csv;
+    int  i;
+
+    for (i = 0; i < node_count; i++) {
+        struct stat_node *node = &nodes[i];
+        int64_t delta = first ? 0 : node->value - node->previous;
+        double  rate = elapsed > 0 ? (double)delta / elapsed : 0;
+
+        /* There is no rate before the second sample */
+        bool    counter = node->kind == NODE_COUNTER && !first;
+
+        if (!first && !all && delta == 0) {
+            continue;
+        }
+
+        if (!header) {
+            printf("\n%-48s %16s %14s %14s\n",
+                   first ? "node (absolute)" : "node", "value", "delta",
+                   "rate/s");
+            header = true;
+        }
+
+        if (csv) {
+            printf("%.6f,%s,%s,%" PRId64 ",%" PRId64 ",", timestamp,
+                   node->name, stat_kind_names[node->kind], node->value, delta);
+            if (counter) {
+                printf("%.3f", rate);
+            }
+            printf("\n");
+        } else if (counter) {
+            printf("%-48s %16" PRId64 " %14" PRId64 " %14.1f\n", node->name,
+                   node->value, delta, rate);
+        } else {
+            printf("%-48s %16" PRId64 " %14" PRId64 " %14s (%s)\n",
+                   node->name, node->value, delta, "-",
+                   stat_kind_names[node->kind]);
+        }
+    }
+
+    fflush(stdout);
+}
+
+int
+main(int argc, char **argv)
+{
+    bool   all      = false;
+    bool   csv      = false;
+    long   count    = -1;
+    double interval = 1.0;
+    char  *end;
+    double previous_time;
+    double deadline;
+    long   sample;
+    int    i;
+    int    ret;
+
+    while (true) {
+        static struct option long_options[] = {
+            { "help", no_argument, NULL, 'h' },
+            { NULL, 0, NULL, 0 }
+        };
+
+        int c = getopt_long(argc, argv, "ac:hw:x", long_options, NULL);
+        if (c == -1) {
+            break;
+        }
+
+        switch (c) {
+            case 'a':
+                all = true;
+                break;
+
+            case 'c':
+                errno = 0;
+                count = strtol(optarg, &end, 10);
+                if (errno || end == optarg || *end != '\0' || count <= 0) {
+                    errx(EX_USAGE, "invalid sample count: %s", optarg);
+                }
+                break;
+
+            case 'w':
+                errno = 0;
+                interval = strtod(optarg, &end);
+                if (errno || end == optarg || *end != '\0' ||
+                    !isfinite(interval) || interval <= 0 ||
+                    interval > STAT_INTERVAL_MAX) {
+                    errx(EX_USAGE, "invalid interval: %s", optarg);
+                }
+                break;
+
+            case 'x':
+                csv = true;
+                break;
+
+            case 'h':
+            case '?':
+            default:
+                showhelp();
+                break;
+        }
+    }
+
+    ret = nodes_discover();
+    if (ret) {
+        errno = ret;
+        err(EX_UNAVAILABLE, "failed to discover nodes under " STAT_SOURCE);
+    }
+    if (node_count == 0) {
+        errx(EX_UNAVAILABLE, "no counters found under " STAT_SOURCE);
+    }
+
+    if (csv) {
+        printf("time,node,kind,value,delta,rate\n");
+    } else {
+        print_version();
+        printf("# %d nodes under " STAT_SOURCE ", interval %.3fs\n",
+               node_count, interval);
+    }
+
+    previous_time = time_monotonic();
+    deadline = previous_time;
+
+    for (sample = 0; count < 0 || sample < count; sample++) {
+        double now;
+        double wall;
+
+        if (sample > 0) {
+            deadline += interval;
+
+            /*
+             * Do not catch up on ticks missed while stopped or slow, but
+             * take the next sample one interval after the late one
+             */
+            if (deadline < previous_time) {
+                deadline = previous_time + interval;
+            }
+
+            sleep_until(deadline);
+        }
+
+        now = time_monotonic();
+        wall = time_now();
+        for (i = 0; i < node_count; i++) {
+            nodes[i].previous = nodes[i].value;
+            ret = node_read(&nodes[i]);
+            if (ret) {
+                /* The node may vanish, e.g. when a volume is unmounted */
+                nodes[i].value = nodes[i].previous;
+            }
+        }
+
+        print_sample(wall, now - previous_time, sample == 0, all, csv);
+        previous_time = now;
+    }
+
+    return 0;
+}
+
+static void
+showhelp(void)
+{
+    fprintf(stderr,
+            "usage: osxfusestat [-a] [-x] [-c count] [-w interval]\n"
+            "\n"
+            "    -a           print all nodes, not only the ones that changed\n"
+            "    -c count     stop after count samples\n"
+            "    -w interval  seconds between samples (default 1, may be fractional,\n"
+            "                 at most 86400)\n"
+            "    -x           print comma-separated values for export\n"
+            "\n"
+            "Rates are only printed for counters. Gauges and tunables show the change\n"
+            "since the previous sample. On Linux, the fusectl nodes are all gauges or\n"
+            "tunables.\n");
+    exit(EX_USAGE);
+}